@@ -2,6 +2,8 @@
 //
 // Logic:
 // - bcreate: The only function that calls mmap (via mmalloc). It initializes the pool and populates the freelist with the largest possible block sizes.
+// - bcreateopt: bcreate with options. BHUGE maps the pool on a 2 MB boundary and requests transparent huge pages. Because buddy addresses are offsets from base, every block of order 21 and above then covers whole huge pages. If THP is unavailable the pool still works on 4 KB pages.
+// - breset: Returns the pool to its just-created state: the freelist metadata is cleared and re-populated, without visiting any allocated block. Every outstanding pointer becomes invalid.
 // - balloc: Rounds requests to the nearest power of two within the range [2^l, 2^u] and retrieves a block from the freelist.
 // - bfree: Detects the block size using internal bitmaps and returns the memory to the freelist manager for merging.
 // - bsize: Queries the freelist bitmaps to return the actual allocated size of a pointer.
@@ -18,36 +20,59 @@ struct balloc_s {
     void *base;
     size_t size;
     int l, u;
+    int opts;
     FreeList fl;
 };
 
+// Bytes actually mapped for the pool: BHUGE rounds up to whole huge pages.
+static size_t mapsize(struct balloc_s *p) {
+    if (p->opts & BHUGE)
+        return divup(p->size, e2size(hugepagee)) * e2size(hugepagee);
+    return p->size;
+}
+
+// Carve the pool into the largest possible blocks and put them on the freelist.
+static void populate(struct balloc_s *p) {
+    char *curr = (char *)p->base;
+    size_t remaining = p->size;
+    for (int i = p->u; i >= p->l; i--) {
+        size_t block_size = e2size(i);
+        while (remaining >= block_size) {
+            freelistfree(p->fl, p->base, curr, i, p->l);
+            curr += block_size;
+            remaining -= block_size;
+        }
+    }
+}
+
 extern Balloc bcreate(unsigned int size, int l, int u) {
+    return bcreateopt(size, l, u, 0);
+}
+
+extern Balloc bcreateopt(unsigned int size, int l, int u, int opts) {
     // FIX: Use mmalloc instead of malloc to avoid wrapper recursion
     struct balloc_s *p = mmalloc(sizeof(struct balloc_s));
     if (p == (void *)-1) return NULL;
     memset(p, 0, sizeof(struct balloc_s)); // mmap is zeroed, but explicit is safer
     
-    p->base = mmalloc(size);
+    p->size = size;
+    p->opts = opts;
+    if (opts & BHUGE) {
+        p->base = mmallocalign(mapsize(p), e2size(hugepagee));
+        if (p->base != (void *)-1)
+            mmhuge(p->base, mapsize(p)); // advisory: falls back to 4 KB pages
+    } else {
+        p->base = mmalloc(size);
+    }
     if (p->base == (void *)-1) {
-        // In a strict implementation, you would free p here
+        mmfree(p, sizeof(struct balloc_s));
         return NULL;
     }
     
-    p->size = size;
     p->l = l;
     p->u = u;
     p->fl = freelistcreate(size, l, u);
-    
-    char *curr = (char *)p->base;
-    size_t remaining = size;
-    for (int i = u; i >= l; i--) {
-        size_t block_size = e2size(i);
-        while (remaining >= block_size) {
-            freelistfree(p->fl, p->base, curr, i, l);
-            curr += block_size;
-            remaining -= block_size;
-        }
-    }
+    populate(p);
     return (Balloc)p;
 }
 
@@ -59,12 +84,19 @@ extern void bdelete(Balloc pool) {
     freelistdelete(p->fl, p->l, p->u);
     
     // Release the managed memory pool
-    mmfree(p->base, p->size);
+    mmfree(p->base, mapsize(p));
     
     // FIX: Release the pool structure itself using mmfree, not free()
     mmfree(p, sizeof(struct balloc_s));
 }
 
+extern void breset(Balloc pool) {
+    struct balloc_s *p = (struct balloc_s *)pool;
+    if (!p) return;
+    freelistreset(p->fl, p->l, p->u);
+    populate(p);
+}
+
 extern void *balloc(Balloc pool, unsigned int size) {
     struct balloc_s *p = (struct balloc_s *)pool;
     if (!p) return NULL;
@@ -93,7 +125,8 @@ extern unsigned int bsize(Balloc pool, void *mem) {
 extern void bprint(Balloc pool) {
     struct balloc_s *p = (struct balloc_s *)pool;
     if (!p) return;
-    printf("Balloc Pool %p: base=%p size=%zu range=[2^%d, 2^%d]\n", 
-           (void*)p, p->base, p->size, p->l, p->u);
+    printf("Balloc Pool %p: base=%p size=%zu range=[2^%d, 2^%d]%s\n", 
+           (void*)p, p->base, p->size, p->l, p->u,
+           (p->opts & BHUGE) ? " huge" : "");
     freelistprint(p->fl, p->l, p->u);
 }
\ No newline at end of file
@@ -3,8 +3,13 @@
 
 typedef void *Balloc;
 
+// bcreateopt() options
+#define BHUGE 1 // 2 MB-aligned base, backed by transparent huge pages if available
+
 extern Balloc bcreate(unsigned int size, int l, int u);
+extern Balloc bcreateopt(unsigned int size, int l, int u, int opts);
 extern void   bdelete(Balloc pool);
+extern void   breset(Balloc pool);
 
 extern void *balloc(Balloc pool, unsigned int size);
 extern void  bfree(Balloc pool, void *mem);
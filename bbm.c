@@ -44,6 +44,8 @@ extern int bbmtst(BBM b, void *base, void *mem, int e) {
   return bmtst(b,bitaddr(base,mem,e));
 }
 
+extern void bbmclrall(BBM b) { bmclrall(b); }
+
 extern void bbmprt(BBM b) { bmprt(b); }
 
 extern void *baddrset(void *base, void *mem, int e) {
@@ -13,6 +13,7 @@ extern void bbmdelete(BBM b);
 extern void bbmset(BBM b, void *base, void *mem, int e);
 extern void bbmclr(BBM b, void *base, void *mem, int e);
 extern  int bbmtst(BBM b, void *base, void *mem, int e);
+extern void bbmclrall(BBM b);
 
 extern void bbmprt(BBM b);
 
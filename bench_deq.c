@@ -0,0 +1,66 @@
+// Deq backend benchmark: queue, stack and index workloads through deq.h.
+// Build once per backend and compare:
+//
+// gcc -O2 -o bench_deq_list bench_deq.c deq.c dequtil.c error.c balloc.c freelist.c bbm.c bm.c utils.c
+// gcc -O2 -o bench_deq_ring bench_deq.c deq_ring.c dequtil.c error.c balloc.c freelist.c bbm.c bm.c utils.c
+
+#include <stdio.h>
+#include <time.h>
+#include "deq.h"
+
+static const int n=1000000; // elements per workload
+static const int lookups=10000;
+
+static double now() {
+  struct timespec t;
+  clock_gettime(CLOCK_MONOTONIC,&t);
+  return t.tv_sec+t.tv_nsec/1e9;
+}
+
+static void fill(Deq q, int len) {
+  for (long i=1; i<=len; i++)
+    deq_tail_put(q,(Data)i);
+}
+
+static void queue() {
+  Deq q=deq_new();
+  double t=now();
+  fill(q,n);
+  while (deq_len(q))
+    deq_head_get(q);
+  printf("queue: %8.3fs\n",now()-t);
+  deq_del(q,0);
+}
+
+static void stack() {
+  Deq q=deq_new();
+  double t=now();
+  fill(q,n);
+  while (deq_len(q))
+    deq_tail_get(q);
+  printf("stack: %8.3fs\n",now()-t);
+  deq_del(q,0);
+}
+
+static void indexed() {
+  Deq q=deq_new();
+  int len=n/10;
+  fill(q,len);
+  unsigned int x=1;
+  long sum=0;
+  double t=now();
+  for (int i=0; i<lookups; i++) {
+    x=x*1103515245+12345;
+    int k=(x>>8)%len;
+    sum+=(long)(i%2 ? deq_head_ith(q,k) : deq_tail_ith(q,k));
+  }
+  printf("index: %8.3fs  [sum %ld]\n",now()-t,sum);
+  deq_del(q,0);
+}
+
+int main() {
+  queue();
+  stack();
+  indexed();
+  return 0;
+}
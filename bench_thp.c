@@ -0,0 +1,86 @@
+// Random-access benchmark for BHUGE pools: compares wall time and dTLB load
+// misses (via perf_event_open) for a plain pool and a huge-page pool.
+//
+// gcc -O2 -o bench_thp bench_thp.c balloc.c freelist.c bbm.c bm.c utils.c
+
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <linux/perf_event.h>
+#include "balloc.h"
+
+static const int poole=28;       // 256 MB pool
+static const long touches=1<<24; // random 8-byte reads per run
+
+// Counter for dTLB read misses in this thread, or -1 if perf is unavailable.
+static int dtlbopen() {
+  struct perf_event_attr a;
+  memset(&a,0,sizeof(a));
+  a.size=sizeof(a);
+  a.type=PERF_TYPE_HW_CACHE;
+  a.config=PERF_COUNT_HW_CACHE_DTLB |
+    (PERF_COUNT_HW_CACHE_OP_READ<<8) |
+    (PERF_COUNT_HW_CACHE_RESULT_MISS<<16);
+  a.disabled=1;
+  a.exclude_kernel=1;
+  a.exclude_hv=1;
+  return syscall(SYS_perf_event_open,&a,0,-1,-1,0);
+}
+
+static double now() {
+  struct timespec t;
+  clock_gettime(CLOCK_MONOTONIC,&t);
+  return t.tv_sec+t.tv_nsec/1e9;
+}
+
+static void run(const char *name, int opts) {
+  size_t size=(size_t)1<<poole;
+  Balloc pool=bcreateopt(size,12,poole,opts);
+  if (!pool) {
+    fprintf(stderr,"%s: bcreateopt() failed\n",name);
+    return;
+  }
+  unsigned long *a=balloc(pool,size);
+  size_t n=size/sizeof(*a);
+  for (size_t i=0; i<n; i++)    // fault every page in
+    a[i]=i;
+
+  int fd=dtlbopen();
+  unsigned long x=88172645463325252UL, sum=0;
+  if (fd!=-1) {
+    ioctl(fd,PERF_EVENT_IOC_RESET,0);
+    ioctl(fd,PERF_EVENT_IOC_ENABLE,0);
+  }
+  double t=now();
+  for (long i=0; i<touches; i++) {
+    x^=x<<13; x^=x>>7; x^=x<<17; // xorshift64
+    sum+=a[x&(n-1)];
+  }
+  t=now()-t;
+  long long misses=-1;
+  if (fd!=-1) {
+    ioctl(fd,PERF_EVENT_IOC_DISABLE,0);
+    if (read(fd,&misses,sizeof(misses))!=sizeof(misses))
+      misses=-1;
+    close(fd);
+  }
+
+  printf("%-6s %8.3fs ",name,t);
+  if (misses<0)
+    printf("dTLB misses: n/a");
+  else
+    printf("dTLB misses: %lld (%.4f/access)",misses,(double)misses/touches);
+  printf("  [sum %lu]\n",sum);
+  bfree(pool,a);
+  bdelete(pool);
+}
+
+int main() {
+  run("4KB",0);
+  run("THP",BHUGE);
+  return 0;
+}
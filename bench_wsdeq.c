@@ -0,0 +1,133 @@
+// Work-stealing benchmark: a divide-and-conquer task tree run by 1..N
+// workers, each owning a queue and stealing from others when idle.
+// Compares the lock-free WSDeq with a mutex-wrapped Deq.
+//
+// gcc -O2 -pthread -o bench_wsdeq bench_wsdeq.c wsdeq.c deq.c dequtil.c error.c balloc.c freelist.c bbm.c bm.c utils.c
+
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <unistd.h>
+#include "deq.h"
+#include "wsdeq.h"
+
+static const long leaves=1<<20; // tasks that do work
+static const int spin=200;      // work per leaf
+#define MAXWORKERS 64
+
+// A task is a leaf range [lo,hi), packed into a non-zero Data.
+static Data task(long lo, long hi) { return (Data)((lo<<32)|hi); }
+static long lo(Data d) { return (long)d>>32; }
+static long hi(Data d) { return (long)d&0xffffffff; }
+
+typedef struct {
+  const char *name;
+  void *(*new)();
+  void (*del)(void *q);
+  void (*put)(void *q, Data d);
+  Data (*get)(void *q);
+  Data (*steal)(void *q);
+} Ops;
+
+static Ops ws={"wsdeq",wsdeq_new,wsdeq_del,wsdeq_put,wsdeq_get,wsdeq_steal};
+
+// The baseline: a Deq behind a mutex; owner at the tail, thieves at the head.
+typedef struct { pthread_mutex_t m; Deq q; } Locked;
+
+static void *lk_new() {
+  Locked *l=malloc(sizeof(*l));
+  pthread_mutex_init(&l->m,0);
+  l->q=deq_new();
+  return l;
+}
+static void lk_del(void *q) {
+  Locked *l=q; deq_del(l->q,0); pthread_mutex_destroy(&l->m); free(l);
+}
+static void lk_put(void *q, Data d) {
+  Locked *l=q;
+  pthread_mutex_lock(&l->m); deq_tail_put(l->q,d); pthread_mutex_unlock(&l->m);
+}
+static Data lk_take(Locked *l, Data (*get)(Deq q)) {
+  pthread_mutex_lock(&l->m);
+  Data d=deq_len(l->q) ? get(l->q) : 0;
+  pthread_mutex_unlock(&l->m);
+  return d;
+}
+static Data lk_get(void *q) { return lk_take(q,deq_tail_get); }
+static Data lk_steal(void *q) { return lk_take(q,deq_head_get); }
+
+static Ops lk={"mutex",lk_new,lk_del,lk_put,lk_get,lk_steal};
+
+static Ops *ops;
+static void *queues[MAXWORKERS];
+static int workers;
+static atomic_long done;
+static atomic_long checksum;
+static int failures;
+
+static void leaf(long i) {
+  volatile long x=i;
+  for (int k=0; k<spin; k++)
+    x=x*31+k;
+  atomic_fetch_add_explicit(&checksum,i,memory_order_relaxed);
+  atomic_fetch_add_explicit(&done,1,memory_order_relaxed);
+}
+
+static void *worker(void *arg) {
+  long me=(long)arg;
+  unsigned int seed=me+1;
+  while (atomic_load_explicit(&done,memory_order_relaxed)<leaves) {
+    Data d=ops->get(queues[me]);
+    for (int tries=0; !d && tries<workers; tries++)
+      d=ops->steal(queues[rand_r(&seed)%workers]);
+    if (!d)
+      continue;
+    long l=lo(d), h=hi(d);
+    while (h-l>1) { // split, keeping the left half
+      long m=l+(h-l)/2;
+      ops->put(queues[me],task(m,h));
+      h=m;
+    }
+    leaf(l);
+  }
+  return 0;
+}
+
+static double run(Ops *o, int n) {
+  ops=o;
+  workers=n;
+  atomic_store(&done,0);
+  atomic_store(&checksum,0);
+  for (int i=0; i<n; i++)
+    queues[i]=o->new();
+  o->put(queues[0],task(0,leaves));
+  struct timespec a, b;
+  clock_gettime(CLOCK_MONOTONIC,&a);
+  pthread_t t[MAXWORKERS];
+  for (long i=0; i<n; i++)
+    pthread_create(&t[i],0,worker,(void *)i);
+  for (int i=0; i<n; i++)
+    pthread_join(t[i],0);
+  clock_gettime(CLOCK_MONOTONIC,&b);
+  for (int i=0; i<n; i++)
+    o->del(queues[i]);
+  if (atomic_load(&checksum)!=leaves*(leaves-1)/2) {
+    fprintf(stderr,"%s: lost or duplicated tasks\n",o->name);
+    failures++;
+  }
+  return (b.tv_sec-a.tv_sec)+(b.tv_nsec-a.tv_nsec)/1e9;
+}
+
+int main() {
+  int cores=sysconf(_SC_NPROCESSORS_ONLN);
+  if (cores>MAXWORKERS)
+    cores=MAXWORKERS;
+  printf("workers    wsdeq    mutex\n");
+  for (int n=1; n<=cores; n=(n<cores && n*2>cores) ? cores : n*2) {
+    double w=run(&ws,n), m=run(&lk,n);
+    printf("%7d %7.3fs %7.3fs\n",n,w,m);
+  }
+  return failures ? 1 : 0;
+}
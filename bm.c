@@ -4,6 +4,7 @@
 // - Allocates a memory block where the first few bytes store metadata (the total bit count) followed by the raw bit data.
 // - bmcreate: Uses mmalloc to obtain memory and initializes all bits to zero.
 // - bmset / bmclr / bmtst: Provides safe access to individual bits. It includes bounds checking (ok function) to ensure indices do not exceed the bitmap size.
+// - bmclrall: Clears every bit with one memset, for resetting a bitmap without per-bit calls.
 // - bmdelete: Frees the memory acquired during creation.
 
 #include <stdlib.h>
@@ -52,6 +53,10 @@ extern int bmtst(BM b, size_t i) {
   ok(b,i); return bittst(b+i/bitsperbyte,i%bitsperbyte);
 }
 
+extern void bmclrall(BM b) {
+  memset(b,0,bmbytes(b));
+}
+
 extern void bmprt(BM b) {
   for (int byte=bmbytes(b)-1; byte>=0; byte--)
     printf("%02x%s",((char *)b)[byte],(byte ? " " : "\n"));
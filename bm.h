@@ -13,6 +13,7 @@ extern void bmdelete(BM b);
 extern void bmset(BM b, size_t i);
 extern void bmclr(BM b, size_t i);
 extern int  bmtst(BM b, size_t i);
+extern void bmclrall(BM b);
 
 extern void bmprt(BM b);
 
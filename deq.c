@@ -4,6 +4,7 @@
 #include <string.h>
 
 #include "deq.h"
+#include "dequtil.h"
 #include "error.h"
 
 /**
@@ -17,6 +18,16 @@
  * * This allows us to write generic helper functions (put, get, etc.) that 
  * take an `End` parameter. Calling `put(r, Head, ...)` performs the exact 
  * symmetric logic to `put(r, Tail, ...)` simply by swapping the indices.
+ * * Nodes put one at a time are malloc'd singly. The *_put_array operations
+ * malloc a `Slab` of nodes at once; a slab counts its live nodes and is
+ * freed with its last one, so nodes stay independent of where they came
+ * from and can move between deques (concat, split_at).
+ * * `deq_new_in(pool)` draws the deque and all its nodes from a caller's
+ * Balloc pool instead of malloc, which keeps them packed together.
+ * `deq_del` then releases everything with one `breset(pool)` instead of
+ * freeing node by node, so the pool must be dedicated to that deque. A
+ * deque split off from it shares the pool without owning it; the owner
+ * counts its sharers and refuses to be deleted before them.
  */
 
 // indices and size of array of node pointers
@@ -25,11 +36,20 @@ typedef enum { Head, Tail, Ends } End;
 typedef struct Node {
   struct Node *np[Ends]; // np[Head] points to Head-ward neighbor, np[Tail] to Tail-ward
   Data data;
+  struct Slab *slab;     // 0 if malloc'd singly
 } *Node;
 
+typedef struct Slab {
+  int live;
+  struct Node node[];
+} *Slab;
+
+static const int slabnodes = 31; // a slab fits in a 1 KB buddy block
+
 typedef struct {
   Node ht[Ends]; // ht[Head] points to the Head node, ht[Tail] points to the Tail node
   int len;
+  DqPool dp;     // where nodes come from, and who owns it
 } *Rep;
 
 static Rep rep(Deq q) {
@@ -38,15 +58,19 @@ static Rep rep(Deq q) {
   return (Rep)q;
 }
 
+static void release(Rep r, Node n) {
+  if (!n->slab)
+    dqfree(r->dp.pool, n);
+  else if (--n->slab->live == 0)
+    dqfree(r->dp.pool, n->slab);
+}
+
 /**
- * put: Add data 'd' to the end 'e'.
- * logic: Allocates node, links its "inward" pointer to old end, 
+ * attach: Add node 'n' holding data 'd' to the end 'e'.
+ * logic: Links its "inward" pointer to old end, 
  * updates old end's "outward" pointer to new node.
  */
-static void put(Rep r, End e, Data d) {
-  Node n = (Node)malloc(sizeof(*n));
-  if (!n)
-    ERROR("malloc() failed");
+static void attach(Rep r, End e, Node n, Data d) {
   n->data = d;
   n->np[e] = 0;          // New node is at the edge, so outward is 0
   n->np[1 - e] = r->ht[e]; // Points "inward" to current end
@@ -62,10 +86,43 @@ static void put(Rep r, End e, Data d) {
 }
 
 /**
- * ith: Retrieve the i-th element starting from end 'e'.
+ * put: Add data 'd' to the end 'e', in a node of its own.
+ */
+static void put(Rep r, End e, Data d) {
+  Node n = (Node)dqalloc(r->dp.pool, sizeof(*n));
+  if (!n)
+    ERROR("malloc() failed");
+  n->slab = 0;
+  attach(r, e, n, d);
+}
+
+/**
+ * put_array: Add a[0..n-1] to the end 'e', as n puts would.
+ * logic: Nodes come from slabs of up to `slabnodes`, one malloc per slab.
+ * A pool too small for a full slab gets smaller ones.
+ */
+static void put_array(Rep r, End e, Data *a, int n) {
+  while (n > 0) {
+    int k = n < slabnodes ? n : slabnodes;
+    Slab s;
+    while (!(s = (Slab)dqalloc(r->dp.pool, sizeof(*s) + k * sizeof(s->node[0]))) && k > 1)
+      k /= 2;
+    if (!s)
+      ERROR("malloc() failed");
+    s->live = k;
+    for (int j = 0; j < k; j++) {
+      s->node[j].slab = s;
+      attach(r, e, &s->node[j], *a++);
+    }
+    n -= k;
+  }
+}
+
+/**
+ * nth: The i-th node starting from end 'e'.
  * logic: Traverses "inward" 'i' times.
  */
-static Data ith(Rep r, End e, int i) {
+static Node nth(Rep r, End e, int i) {
   if (i < 0 || i >= r->len)
     ERROR("index out of bounds");
   Node curr = r->ht[e];
@@ -73,9 +130,14 @@ static Data ith(Rep r, End e, int i) {
     curr = curr->np[1 - e]; // Move "inward"
     i--;
   }
-  return curr->data;
+  return curr;
 }
 
+/**
+ * ith: Retrieve the i-th element starting from end 'e'.
+ */
+static Data ith(Rep r, End e, int i) { return nth(r, e, i)->data; }
+
 /**
  * get: Remove and return data from end 'e'.
  * logic: removing the last node updates both Head/Tail to 0.
@@ -94,11 +156,21 @@ static Data get(Rep r, End e) {
     r->ht[e] = n->np[1 - e]; // Move end pointer "inward"
     r->ht[e]->np[e] = 0;     // New end has no "outward" neighbor
   }
-  free(n);
+  release(r, n);
   r->len--;
   return d;
 }
 
+/**
+ * get_array: Get up to 'n' elements from end 'e' into 'a', as gets would.
+ */
+static int get_array(Rep r, End e, Data *a, int n) {
+  int k = 0;
+  while (k < n && r->len > 0)
+    a[k++] = get(r, e);
+  return k;
+}
+
 /**
  * rem: Remove the first occurrence of 'd' starting search from end 'e'.
  * logic: Traverses "inward". If found, relinks neighbors to bypass current node.
@@ -122,7 +194,7 @@ static Data rem(Rep r, End e, Data d) {
         r->ht[1 - e] = prev; // Was the other end node (list became empty or singleton)
 
       Data ret = curr->data;
-      free(curr);
+      release(r, curr);
       r->len--;
       return ret;
     }
@@ -131,16 +203,25 @@ static Data rem(Rep r, End e, Data d) {
   return 0; // Not found
 }
 
-extern Deq deq_new() {
-  Rep r = (Rep)malloc(sizeof(*r));
+static Rep new(Balloc pool, int own) {
+  Rep r = (Rep)dqalloc(pool, sizeof(*r));
   if (!r)
     ERROR("malloc() failed");
   r->ht[Head] = 0;
   r->ht[Tail] = 0;
   r->len = 0;
+  dqpoolinit(&r->dp, pool, own);
   return r;
 }
 
+extern Deq deq_new() { return new(0, 0); }
+
+extern Deq deq_new_in(Balloc pool) {
+  if (!pool)
+    ERROR("zero pointer");
+  return new(pool, 1);
+}
+
 extern int deq_len(Deq q) { return rep(q)->len; }
 
 extern void deq_head_put(Deq q, Data d) { put(rep(q), Head, d); }
@@ -148,10 +229,84 @@ extern Data deq_head_get(Deq q) { return get(rep(q), Head); }
 extern Data deq_head_ith(Deq q, int i) { return ith(rep(q), Head, i); }
 extern Data deq_head_rem(Deq q, Data d) { return rem(rep(q), Head, d); }
 
+extern void deq_head_put_array(Deq q, Data *a, int n) { put_array(rep(q), Head, a, n); }
+extern int  deq_head_get_array(Deq q, Data *a, int n) { return get_array(rep(q), Head, a, n); }
+
 extern void deq_tail_put(Deq q, Data d) { put(rep(q), Tail, d); }
 extern Data deq_tail_get(Deq q) { return get(rep(q), Tail); }
 extern Data deq_tail_ith(Deq q, int i) { return ith(rep(q), Tail, i); }
 extern Data deq_tail_rem(Deq q, Data d) { return rem(rep(q), Tail, d); }
+extern void deq_tail_put_array(Deq q, Data *a, int n) { put_array(rep(q), Tail, a, n); }
+extern int  deq_tail_get_array(Deq q, Data *a, int n) { return get_array(rep(q), Tail, a, n); }
+
+/**
+ * deq_concat: Splice all of 'b' onto the tail of 'a' in O(1); 'b' is left
+ * empty. Nodes move with their slabs' counts, so no node is copied.
+ */
+extern void deq_concat(Deq a, Deq b) {
+  Rep ra = rep(a), rb = rep(b);
+  if (ra == rb)
+    ERROR("concat of a deque with itself");
+  dqpoolsame(&ra->dp, &rb->dp);
+  if (rb->len == 0)
+    return;
+  if (ra->len == 0) {
+    ra->ht[Head] = rb->ht[Head];
+  } else {
+    ra->ht[Tail]->np[Tail] = rb->ht[Head];
+    rb->ht[Head]->np[Head] = ra->ht[Tail];
+  }
+  ra->ht[Tail] = rb->ht[Tail];
+  ra->len += rb->len;
+  rb->ht[Head] = 0;
+  rb->ht[Tail] = 0;
+  rb->len = 0;
+}
+
+/**
+ * deq_split_at: Move the elements from head-index 'i' onward into a new
+ * deque. logic: Finds the cut from the nearer end, then relinks in O(1).
+ */
+extern Deq deq_split_at(Deq q, int i) {
+  Rep r = rep(q);
+  if (i < 0 || i > r->len)
+    ERROR("index out of bounds");
+  Rep s = new(r->dp.pool, 0);
+  dqpoolshare(&s->dp, &r->dp);
+  if (i == r->len)
+    return s;
+  Node n = (i <= r->len - 1 - i) ? nth(r, Head, i) : nth(r, Tail, r->len - 1 - i);
+  s->ht[Head] = n;
+  s->ht[Tail] = r->ht[Tail];
+  s->len = r->len - i;
+  r->ht[Tail] = n->np[Head];
+  if (r->ht[Tail])
+    r->ht[Tail]->np[Tail] = 0;
+  else
+    r->ht[Head] = 0;
+  n->np[Head] = 0;
+  r->len = i;
+  return s;
+}
+
+static DeqIter iter(Rep r, End e) {
+  DeqIter it = {r, r->ht[e], 0, e};
+  return it;
+}
+
+extern DeqIter deq_head_iter(Deq q) { return iter(rep(q), Head); }
+extern DeqIter deq_tail_iter(Deq q) { return iter(rep(q), Tail); }
+
+extern int deq_iter_more(DeqIter *it) { return it->n != 0; }
+
+extern Data deq_iter_next(DeqIter *it) {
+  Node n = (Node)it->n;
+  if (!n)
+    ERROR("iterator past end");
+  it->n = n->np[1 - it->e]; // Move "inward"
+  it->i++;
+  return n->data;
+}
 
 extern void deq_map(Deq q, DeqMapF f) {
   // Map always traverses Head -> Tail
@@ -160,27 +315,46 @@ extern void deq_map(Deq q, DeqMapF f) {
 }
 
 extern void deq_del(Deq q, DeqMapF f) {
+  Rep r = rep(q);
+  int own = dqpooldel(&r->dp);
   if (f)
     deq_map(q, f);
-  Node curr = rep(q)->ht[Head];
+  if (own) { // every node, and r itself, at once
+    breset(r->dp.pool);
+    return;
+  }
+  Node curr = r->ht[Head];
   while (curr) {
     Node next = curr->np[Tail];
-    free(curr);
+    release(r, curr);
     curr = next;
   }
-  free(q);
+  dqfree(r->dp.pool, r);
 }
 
 extern Str deq_str(Deq q, DeqStrF f) {
-  char *s = strdup("");
+  size_t cap = 1;
+  if (!f) // data are the strings: size the buffer exactly, no regrowth
+    for (Node n = rep(q)->ht[Head]; n; n = n->np[Tail])
+      cap += strlen(n->data) + 1;
+  Buf b;
+  bufinit(&b, f ? 64 : cap);
   for (Node n = rep(q)->ht[Head]; n; n = n->np[Tail]) {
     char *d = f ? f(n->data) : n->data;
-    char *t;
-    asprintf(&t, "%s%s%s", s, (*s ? " " : ""), d);
-    free(s);
-    s = t;
+    bufcat(&b, d, n == rep(q)->ht[Head]);
+    if (f)
+      free(d);
+  }
+  return b.s;
+}
+
+extern void deq_fprint(Deq q, FILE *fp, DeqStrF f) {
+  for (Node n = rep(q)->ht[Head]; n; n = n->np[Tail]) {
+    char *d = f ? f(n->data) : n->data;
+    if (n != rep(q)->ht[Head])
+      fputc(' ', fp);
+    fputs(d, fp);
     if (f)
       free(d);
   }
-  return s;
 }
\ No newline at end of file
@@ -1,26 +1,48 @@
 #ifndef DEQ_H
 #define DEQ_H
 
+#include <stdio.h>
+
+#include "balloc.h"
+
 // put: append onto an end, len++
 // get: return from an end, len--
 // ith: return by 0-base index, len unchanged
 // rem: return by == comparing, len-- (iff found)
+// put_array: put a[0..n-1] in order, len+=n
+// get_array: get up to n into a[], return how many
 
 typedef void *Deq;
 typedef void *Data;
 
 extern Deq deq_new();
+extern Deq deq_new_in(Balloc pool); // nodes from pool; deq_del resets it
 extern int deq_len(Deq q);
 
 extern void deq_head_put(Deq q, Data d);
 extern Data deq_head_get(Deq q);
 extern Data deq_head_ith(Deq q, int i);
 extern Data deq_head_rem(Deq q, Data d);
+extern void deq_head_put_array(Deq q, Data *a, int n);
+extern int  deq_head_get_array(Deq q, Data *a, int n);
 
 extern void deq_tail_put(Deq q, Data d);
 extern Data deq_tail_get(Deq q);
 extern Data deq_tail_ith(Deq q, int i);
 extern Data deq_tail_rem(Deq q, Data d);
+extern void deq_tail_put_array(Deq q, Data *a, int n);
+extern int  deq_tail_get_array(Deq q, Data *a, int n);
+
+extern void deq_concat(Deq a, Deq b);     // move all of b onto a's tail; same pool
+extern Deq  deq_split_at(Deq q, int i);   // move head-index i.. into a new Deq
+
+// A cursor from either end; q must not change while it is in use.
+typedef struct { Deq q; void *n; int i, e; } DeqIter;
+
+extern DeqIter deq_head_iter(Deq q); // Head -> Tail
+extern DeqIter deq_tail_iter(Deq q); // Tail -> Head
+extern int     deq_iter_more(DeqIter *it);
+extern Data    deq_iter_next(DeqIter *it);
 
 typedef char *Str;
 typedef void (*DeqMapF)(Data d);
@@ -29,5 +51,6 @@ typedef Str  (*DeqStrF)(Data d);
 extern void deq_map(Deq q, DeqMapF f); // foreach
 extern void deq_del(Deq q, DeqMapF f); // free
 extern Str  deq_str(Deq q, DeqStrF f); // toString
+extern void deq_fprint(Deq q, FILE *fp, DeqStrF f); // toString, streamed
 
 #endif
@@ -0,0 +1,285 @@
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "deq.h"
+#include "dequtil.h"
+#include "error.h"
+
+/**
+ * IMPLEMENTATION STRATEGY: Symmetric Circular Array
+ * * An alternative to deq.c behind the same deq.h API; link one or the other.
+ * * - Elements live contiguously in `buf`, a power-of-two sized ring that
+ * doubles when full. No allocation happens per element.
+ * - `slot(r, e, i)` maps "the i-th element from end `e`" to a buffer index,
+ * so ith is O(1) from either end.
+ * - `slot(r, e, -1)` is the free cell just outward of end `e`, which is
+ * where `put(r, e, ...)` stores. As in deq.c, every helper takes an `End`
+ * and is written once for both ends.
+ * * `deq_new_in(pool)` takes the deque and its ring from a caller's Balloc
+ * pool, and `deq_del` releases them with one `breset(pool)`, as in deq.c,
+ * including the rule that split-off sharers are deleted first.
+ * The ring is then limited to the pool's largest block.
+ */
+
+// the two ends, and how many there are
+typedef enum { Head, Tail, Ends } End;
+
+static const int mincap = 8;
+
+typedef struct {
+  Data *buf; // ring of cap elements, head at buf[first]
+  int cap;   // power of two
+  int first;
+  int len;
+  DqPool dp;   // where the ring comes from, and who owns it
+} *Rep;
+
+static Rep rep(Deq q) {
+  if (!q)
+    ERROR("zero pointer");
+  return (Rep)q;
+}
+
+/**
+ * slot: Buffer index of the i-th element from end 'e'.
+ * logic: Head counts up from `first`, Tail counts down from the last element.
+ */
+static int slot(Rep r, End e, int i) {
+  int k = (e == Head) ? r->first + i : r->first + r->len - 1 - i;
+  return k & (r->cap - 1);
+}
+
+/**
+ * grow: Double the capacity until 'need' elements fit, unwrapping the ring
+ * so the head is at index 0.
+ */
+static void grow(Rep r, int need) {
+  int cap = r->cap ? r->cap * 2 : mincap;
+  while (cap < need)
+    cap *= 2;
+  Data *buf = (Data *)dqalloc(r->dp.pool, cap * sizeof(*buf));
+  if (!buf)
+    ERROR("malloc() failed");
+  for (int i = 0; i < r->len; i++)
+    buf[i] = r->buf[slot(r, Head, i)];
+  if (r->buf)
+    dqfree(r->dp.pool, r->buf);
+  r->buf = buf;
+  r->cap = cap;
+  r->first = 0;
+}
+
+/**
+ * put: Add data 'd' to the end 'e'.
+ * logic: Stores into the cell just outward of end 'e'. Only a Head put
+ * moves `first`.
+ */
+static void put(Rep r, End e, Data d) {
+  if (r->len == r->cap)
+    grow(r, r->len + 1);
+  int s = slot(r, e, -1);
+  r->buf[s] = d;
+  if (e == Head)
+    r->first = s;
+  r->len++;
+}
+
+/**
+ * ith: Retrieve the i-th element starting from end 'e'.
+ */
+static Data ith(Rep r, End e, int i) {
+  if (i < 0 || i >= r->len)
+    ERROR("index out of bounds");
+  return r->buf[slot(r, e, i)];
+}
+
+/**
+ * get: Remove and return data from end 'e'.
+ */
+static Data get(Rep r, End e) {
+  if (r->len == 0)
+    ERROR("get from empty deque");
+  Data d = r->buf[slot(r, e, 0)];
+  if (e == Head)
+    r->first = slot(r, Head, 1);
+  r->len--;
+  return d;
+}
+
+/**
+ * put_array / get_array: As 'n' puts or gets at end 'e', with at most
+ * one regrowth.
+ */
+static void put_array(Rep r, End e, Data *a, int n) {
+  if (r->len + n > r->cap)
+    grow(r, r->len + n);
+  for (int i = 0; i < n; i++)
+    put(r, e, a[i]);
+}
+
+static int get_array(Rep r, End e, Data *a, int n) {
+  int k = 0;
+  while (k < n && r->len > 0)
+    a[k++] = get(r, e);
+  return k;
+}
+
+/**
+ * rem: Remove the first occurrence of 'd' starting search from end 'e'.
+ * logic: Shifts the elements between end 'e' and the match one cell
+ * inward, then drops end 'e'. Only the searched side moves.
+ */
+static Data rem(Rep r, End e, Data d) {
+  for (int i = 0; i < r->len; i++) {
+    if (r->buf[slot(r, e, i)] == d) { // Found it (pointer comparison)
+      for (; i > 0; i--)
+        r->buf[slot(r, e, i)] = r->buf[slot(r, e, i - 1)];
+      get(r, e);
+      return d;
+    }
+  }
+  return 0; // Not found
+}
+
+static Rep new(Balloc pool, int own) {
+  Rep r = (Rep)dqalloc(pool, sizeof(*r));
+  if (!r)
+    ERROR("malloc() failed");
+  r->buf = 0;
+  r->cap = 0;
+  r->first = 0;
+  r->len = 0;
+  dqpoolinit(&r->dp, pool, own);
+  return r;
+}
+
+extern Deq deq_new() { return new(0, 0); }
+
+extern Deq deq_new_in(Balloc pool) {
+  if (!pool)
+    ERROR("zero pointer");
+  return new(pool, 1);
+}
+
+extern int deq_len(Deq q) { return rep(q)->len; }
+
+extern void deq_head_put(Deq q, Data d) { put(rep(q), Head, d); }
+extern Data deq_head_get(Deq q) { return get(rep(q), Head); }
+extern Data deq_head_ith(Deq q, int i) { return ith(rep(q), Head, i); }
+extern Data deq_head_rem(Deq q, Data d) { return rem(rep(q), Head, d); }
+
+extern void deq_head_put_array(Deq q, Data *a, int n) { put_array(rep(q), Head, a, n); }
+extern int  deq_head_get_array(Deq q, Data *a, int n) { return get_array(rep(q), Head, a, n); }
+
+extern void deq_tail_put(Deq q, Data d) { put(rep(q), Tail, d); }
+extern Data deq_tail_get(Deq q) { return get(rep(q), Tail); }
+extern Data deq_tail_ith(Deq q, int i) { return ith(rep(q), Tail, i); }
+extern Data deq_tail_rem(Deq q, Data d) { return rem(rep(q), Tail, d); }
+extern void deq_tail_put_array(Deq q, Data *a, int n) { put_array(rep(q), Tail, a, n); }
+extern int  deq_tail_get_array(Deq q, Data *a, int n) { return get_array(rep(q), Tail, a, n); }
+
+/**
+ * deq_concat: Move all of 'b' onto the tail of 'a'; 'b' is left empty.
+ * logic: Elements are copied, so this is O(len b) rather than a splice.
+ */
+extern void deq_concat(Deq a, Deq b) {
+  Rep ra = rep(a), rb = rep(b);
+  if (ra == rb)
+    ERROR("concat of a deque with itself");
+  dqpoolsame(&ra->dp, &rb->dp);
+  if (ra->len + rb->len > ra->cap)
+    grow(ra, ra->len + rb->len);
+  for (int i = 0; i < rb->len; i++)
+    put(ra, Tail, rb->buf[slot(rb, Head, i)]);
+  rb->first = 0;
+  rb->len = 0;
+}
+
+/**
+ * deq_split_at: Move the elements from head-index 'i' onward into a new
+ * deque, copying them.
+ */
+extern Deq deq_split_at(Deq q, int i) {
+  Rep r = rep(q);
+  if (i < 0 || i > r->len)
+    ERROR("index out of bounds");
+  Rep s = new(r->dp.pool, 0);
+  dqpoolshare(&s->dp, &r->dp);
+  if (i < r->len)
+    grow(s, r->len - i);
+  for (int k = i; k < r->len; k++)
+    put(s, Tail, r->buf[slot(r, Head, k)]);
+  r->len = i;
+  return s;
+}
+
+static DeqIter iter(Rep r, End e) {
+  DeqIter it = {r, 0, 0, e};
+  return it;
+}
+
+extern DeqIter deq_head_iter(Deq q) { return iter(rep(q), Head); }
+extern DeqIter deq_tail_iter(Deq q) { return iter(rep(q), Tail); }
+
+extern int deq_iter_more(DeqIter *it) { return it->i < rep(it->q)->len; }
+
+extern Data deq_iter_next(DeqIter *it) {
+  Rep r = rep(it->q);
+  if (it->i >= r->len)
+    ERROR("iterator past end");
+  return r->buf[slot(r, it->e, it->i++)];
+}
+
+extern void deq_map(Deq q, DeqMapF f) {
+  // Map always traverses Head -> Tail
+  Rep r = rep(q);
+  for (int i = 0; i < r->len; i++)
+    f(r->buf[slot(r, Head, i)]);
+}
+
+extern void deq_del(Deq q, DeqMapF f) {
+  Rep r = rep(q);
+  int own = dqpooldel(&r->dp);
+  if (f)
+    deq_map(q, f);
+  if (own) { // ring and r itself, at once
+    breset(r->dp.pool);
+    return;
+  }
+  if (r->buf)
+    dqfree(r->dp.pool, r->buf);
+  dqfree(r->dp.pool, r);
+}
+
+extern Str deq_str(Deq q, DeqStrF f) {
+  Rep r = rep(q);
+  size_t cap = 1;
+  if (!f) // data are the strings: size the buffer exactly, no regrowth
+    for (int i = 0; i < r->len; i++)
+      cap += strlen(r->buf[slot(r, Head, i)]) + 1;
+  Buf b;
+  bufinit(&b, f ? 64 : cap);
+  for (int i = 0; i < r->len; i++) {
+    Data e = r->buf[slot(r, Head, i)];
+    char *d = f ? f(e) : e;
+    bufcat(&b, d, i == 0);
+    if (f)
+      free(d);
+  }
+  return b.s;
+}
+
+extern void deq_fprint(Deq q, FILE *fp, DeqStrF f) {
+  Rep r = rep(q);
+  for (int i = 0; i < r->len; i++) {
+    Data e = r->buf[slot(r, Head, i)];
+    char *d = f ? f(e) : e;
+    if (i)
+      fputc(' ', fp);
+    fputs(d, fp);
+    if (f)
+      free(d);
+  }
+}
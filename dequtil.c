@@ -0,0 +1,75 @@
+// Purpose: Code common to both Deq backends, linked with whichever one is used.
+//
+// Logic:
+// - dqalloc / dqfree: Route a deque's allocations to its Balloc pool (deq_new_in) or to malloc/free (deq_new).
+// - DqPool: Pool ownership for deq_new_in. dqpoolshare counts a split-off deque as a sharer of the pool's owner; dqpooldel refuses to delete an owner that still has sharers, and otherwise tells the caller whether to release everything with breset.
+// - bufinit: Allocates an empty string with room for cap bytes.
+// - bufcat: Appends a string, preceded by a space unless the caller says it is the first element. Position, not buffer length, decides, so empty elements are separated exactly as deq_fprint separates them. Capacity doubles when full, so appending a total of N bytes copies O(N) bytes and reallocates O(log N) times.
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "dequtil.h"
+#include "error.h"
+
+extern void bufinit(Buf *b, size_t cap) {
+  b->s = (char *)malloc(cap);
+  if (!b->s)
+    ERROR("malloc() failed");
+  b->s[0] = 0;
+  b->len = 0;
+  b->cap = cap;
+}
+
+extern void bufcat(Buf *b, const char *d, int first) {
+  size_t k = strlen(d);
+  size_t need = b->len + 1 + k + 1; // separator, d, terminator
+  if (need > b->cap) {
+    while (need > b->cap)
+      b->cap *= 2;
+    b->s = (char *)realloc(b->s, b->cap);
+    if (!b->s)
+      ERROR("realloc() failed");
+  }
+  if (!first)
+    b->s[b->len++] = ' ';
+  memcpy(b->s + b->len, d, k + 1);
+  b->len += k;
+}
+
+extern void *dqalloc(Balloc pool, size_t size) {
+  return pool ? balloc(pool, size) : malloc(size);
+}
+
+extern void dqfree(Balloc pool, void *p) {
+  if (pool)
+    bfree(pool, p);
+  else
+    free(p);
+}
+
+extern void dqpoolinit(DqPool *p, Balloc pool, int own) {
+  p->pool = pool;
+  p->own = own;
+  p->sharers = 0;
+  p->owner = 0;
+}
+
+extern void dqpoolshare(DqPool *p, DqPool *from) {
+  p->owner = from->own ? from : from->owner;
+  if (p->owner)
+    p->owner->sharers++;
+}
+
+extern void dqpoolsame(DqPool *a, DqPool *b) {
+  if (a->pool != b->pool)
+    ERROR("concat of deques with different pools");
+}
+
+extern int dqpooldel(DqPool *p) {
+  if (p->own && p->sharers)
+    ERROR("deq_del() of a pool's owner before deques split from it");
+  if (p->owner)
+    p->owner->sharers--;
+  return p->own;
+}
@@ -0,0 +1,38 @@
+// Helpers shared by the Deq backends (deq.c, deq_ring.c).
+
+#ifndef DEQUTIL_H
+#define DEQUTIL_H
+
+#include <stdio.h>
+
+#include "balloc.h"
+
+// A growable string, for deq_str.
+typedef struct {
+  char *s;
+  size_t len, cap;
+} Buf;
+
+extern void bufinit(Buf *b, size_t cap);
+extern void bufcat(Buf *b, const char *d, int first);
+
+// Memory for a deque: from its pool, or malloc if pool is 0.
+extern void *dqalloc(Balloc pool, size_t size);
+extern void  dqfree(Balloc pool, void *p);
+
+// A deque's pool and its ownership. A deque made by deq_new_in owns its
+// pool, and deq_del resets it. Deques split from it share the pool, and
+// the owner cannot be deleted while they are alive.
+typedef struct DqPool {
+  Balloc pool;          // 0 for malloc
+  int own;              // deq_del may breset(pool)
+  int sharers;          // if own: live deques split from this one
+  struct DqPool *owner; // if shared: the owner's DqPool
+} DqPool;
+
+extern void dqpoolinit(DqPool *p, Balloc pool, int own);
+extern void dqpoolshare(DqPool *p, DqPool *from); // p's deque split from from's
+extern void dqpoolsame(DqPool *a, DqPool *b);     // deq_concat: same pool or ERROR
+extern int  dqpooldel(DqPool *p);                 // deq_del: 1 iff the caller resets
+
+#endif
@@ -4,6 +4,7 @@
 // - Data Structures: Maintains an array of list heads, one for each possible power-of-two order from l to u.
 // - Management Data: Management pointers (linked list pointers) are stored at the beginning of free blocks themselves, ensuring no extra memory is wasted in allocated blocks.
 // - Splitting (Allocation): If a requested order is empty, the module searches higher orders for a block. When a larger block is found, it is recursively split into "buddies" until the requested size is reached.
+// - Reset: Empties every list head and clears every bitmap in place, so the cost depends on the metadata size rather than on how many blocks are allocated.
 // - Merging (Deallocation): When a block is freed, the module uses buddy bitmaps to check if the adjacent buddy is also free. If it is, the buddies are coalesced into a single larger block, and the process repeats for the next higher order.
 
 #include <stdlib.h>
@@ -69,6 +70,15 @@ extern void freelistdelete(FreeList f, int l, int u) {
     mmfree(fl, sizeof(struct freelist_s));
 }
 
+extern void freelistreset(FreeList f, int l, int u) {
+    FL fl = (FL)f;
+    memset(fl->heads, 0, (u + 1) * sizeof(void *));
+    for (int i = l; i <= u; i++) {
+        bbmclrall(fl->bbms[i]);
+        bmclrall(fl->is_alloc[i]);
+    }
+}
+
 extern void *freelistalloc(FreeList f, void *base, int e, int l) {
     FL fl = (FL)f;
     int k = e;
@@ -7,6 +7,7 @@ typedef void *FreeList;
 
 extern FreeList freelistcreate(size_t size, int l, int u);
 extern void     freelistdelete(FreeList f, int l, int u);
+extern void     freelistreset(FreeList f, int l, int u);
 
 extern void *freelistalloc(FreeList f, void *base, int e, int l);
 extern void  freelistfree(FreeList f, void *base, void *mem, int e, int l);
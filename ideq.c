@@ -0,0 +1,116 @@
+#include "ideq.h"
+#include "error.h"
+
+/**
+ * IMPLEMENTATION STRATEGY: Intrusive Symmetric Doubly-Linked List
+ * * The links of deq.c, moved into the caller's structs. The caller owns
+ * the memory of both the IDeq and every IDeqLink, so puts and gets never
+ * allocate and cannot fail.
+ * * - `np[e]` is the "OUTWARD" link (towards the `e` end), `np[1-e]` the
+ * "INWARD" link, exactly as in deq.c.
+ * * - A link knows its own neighbors, so `rem` unlinks in O(1) instead of
+ * scanning for a matching `Data`. A link whose `np[e]` is 0 is end `e`.
+ */
+
+// indices and size of array of link pointers
+typedef enum { Head, Tail, Ends } End;
+
+static IDeq *rep(IDeq *q) {
+  if (!q)
+    ERROR("zero pointer");
+  return q;
+}
+
+/**
+ * detach: Bypass 'l', which must be in 'q'.
+ * logic: Each side of 'l' is either a neighbor or, if 0, an end of 'q'.
+ */
+static void detach(IDeq *q, IDeqLink *l) {
+  for (End e = Head; e < Ends; e++) {
+    if (l->np[e])
+      l->np[e]->np[1 - e] = l->np[1 - e];
+    else
+      q->ht[e] = l->np[1 - e];
+  }
+  l->np[Head] = 0;
+  l->np[Tail] = 0;
+  q->len--;
+}
+
+/**
+ * put: Add link 'l' to the end 'e'.
+ */
+static void put(IDeq *q, End e, IDeqLink *l) {
+  if (!l)
+    ERROR("zero pointer");
+  l->np[e] = 0;          // New link is at the edge, so outward is 0
+  l->np[1 - e] = q->ht[e]; // Points "inward" to current end
+  if (q->len == 0)
+    q->ht[1 - e] = l;
+  else
+    q->ht[e]->np[e] = l; // Old end points "outward" to new link
+  q->ht[e] = l;
+  q->len++;
+}
+
+/**
+ * ith: Retrieve the i-th link starting from end 'e'.
+ * logic: Traverses "inward" 'i' times.
+ */
+static IDeqLink *ith(IDeq *q, End e, int i) {
+  if (i < 0 || i >= q->len)
+    ERROR("index out of bounds");
+  IDeqLink *curr = q->ht[e];
+  while (i > 0) {
+    curr = curr->np[1 - e]; // Move "inward"
+    i--;
+  }
+  return curr;
+}
+
+/**
+ * get: Unlink and return the link at end 'e'.
+ */
+static IDeqLink *get(IDeq *q, End e) {
+  if (q->len == 0)
+    ERROR("get from empty deque");
+  IDeqLink *l = q->ht[e];
+  detach(q, l);
+  return l;
+}
+
+extern void ideq_init(IDeq *q) {
+  rep(q)->ht[Head] = 0;
+  q->ht[Tail] = 0;
+  q->len = 0;
+}
+
+extern int ideq_len(IDeq *q) { return rep(q)->len; }
+
+extern void      ideq_head_put(IDeq *q, IDeqLink *l) { put(rep(q), Head, l); }
+extern IDeqLink *ideq_head_get(IDeq *q) { return get(rep(q), Head); }
+extern IDeqLink *ideq_head_ith(IDeq *q, int i) { return ith(rep(q), Head, i); }
+
+extern void      ideq_tail_put(IDeq *q, IDeqLink *l) { put(rep(q), Tail, l); }
+extern IDeqLink *ideq_tail_get(IDeq *q) { return get(rep(q), Tail); }
+extern IDeqLink *ideq_tail_ith(IDeq *q, int i) { return ith(rep(q), Tail, i); }
+
+extern void ideq_rem(IDeq *q, IDeqLink *l) {
+  if (!l)
+    ERROR("zero pointer");
+  if (rep(q)->len == 0)
+    ERROR("rem from empty deque");
+  // A detached link has no neighbors, like a lone one; only the latter is an end
+  if (!l->np[Head] && !l->np[Tail] && q->ht[Head] != l)
+    ERROR("link not in deque");
+  detach(q, l);
+}
+
+extern void ideq_map(IDeq *q, IDeqMapF f) {
+  // Map always traverses Head -> Tail; f may rem the link it is given
+  IDeqLink *next;
+  for (IDeqLink *l = rep(q)->ht[Head]; l; l = next) {
+    next = l->np[Tail];
+    f(l);
+  }
+}
@@ -0,0 +1,44 @@
+#ifndef IDEQ_H
+#define IDEQ_H
+
+#include <stddef.h>
+
+// An intrusive Deq: callers embed an IDeqLink in their own structs, so no
+// operation allocates. Same symmetric Head/Tail design as deq.c.
+//
+// put: append a link onto an end, len++
+// get: unlink and return from an end, len--
+// ith: return by 0-base index, len unchanged
+// rem: unlink a given link in O(1), len--
+
+typedef struct IDeqLink {
+  struct IDeqLink *np[2]; // np[Head] Head-ward neighbor, np[Tail] Tail-ward
+} IDeqLink;
+
+typedef struct {
+  IDeqLink *ht[2]; // ht[Head] Head link, ht[Tail] Tail link
+  int len;
+} IDeq;
+
+// The struct containing link l, e.g. IDEQ_ENTRY(l, struct task, link)
+#define IDEQ_ENTRY(l, type, member) \
+  ((type *)((char *)(l) - offsetof(type, member)))
+
+extern void ideq_init(IDeq *q);
+extern int  ideq_len(IDeq *q);
+
+extern void      ideq_head_put(IDeq *q, IDeqLink *l);
+extern IDeqLink *ideq_head_get(IDeq *q);
+extern IDeqLink *ideq_head_ith(IDeq *q, int i);
+
+extern void      ideq_tail_put(IDeq *q, IDeqLink *l);
+extern IDeqLink *ideq_tail_get(IDeq *q);
+extern IDeqLink *ideq_tail_ith(IDeq *q, int i);
+
+extern void ideq_rem(IDeq *q, IDeqLink *l); // l must be in q
+
+typedef void (*IDeqMapF)(IDeqLink *l);
+
+extern void ideq_map(IDeq *q, IDeqMapF f); // foreach, Head -> Tail
+
+#endif
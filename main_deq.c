@@ -1,15 +1,106 @@
+// Deq tests; run once per backend:
+//
+// gcc -pthread -o deq_test main_deq.c deq.c dequtil.c ideq.c wsdeq.c error.c balloc.c freelist.c bbm.c bm.c utils.c
+// gcc -pthread -o deq_ring_test main_deq.c deq_ring.c dequtil.c ideq.c wsdeq.c error.c balloc.c freelist.c bbm.c bm.c utils.c
+
 #include <stdio.h>
 #include <stdlib.h>
 #include <assert.h>
+#include <string.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include <sys/wait.h>
 #include "deq.h"
+#include "ideq.h"
+#include "wsdeq.h"
+
+struct item {
+    int id;
+    IDeqLink link;
+};
+
+// Owner plus thieves on one WSDeq: every element must be taken exactly once
+#define WSITEMS 100000
+#define WSTHIEVES 4
+static WSDeq wq;
+static atomic_int taken[WSITEMS + 1];
+static atomic_int wsdone;
+
+static void take(Data d) { atomic_fetch_add(&taken[(long)d], 1); }
+
+static void *thief(void *unused) {
+    (void)unused;
+    while (!atomic_load(&wsdone)) {
+        Data d = wsdeq_steal(wq);
+        if (d) take(d);
+    }
+    return NULL;
+}
+
+static void wsdeq_race(void) {
+    pthread_t t[WSTHIEVES];
+    wq = wsdeq_new();
+    for (int i = 0; i < WSTHIEVES; i++) pthread_create(&t[i], NULL, thief, NULL);
+    for (long i = 1; i <= WSITEMS; i++) {
+        wsdeq_put(wq, (Data)i);
+        if (i % 3 == 0) { // Owner takes some back while thieves steal
+            Data d = wsdeq_get(wq);
+            if (d) take(d);
+        }
+    }
+    Data d;
+    while ((d = wsdeq_get(wq))) take(d);
+    atomic_store(&wsdone, 1);
+    for (int i = 0; i < WSTHIEVES; i++) pthread_join(t[i], NULL);
+    for (int i = 1; i <= WSITEMS; i++) assert(atomic_load(&taken[i]) == 1);
+    wsdeq_del(wq);
+}
+
+// Run f(a, b) in a child; true iff it stopped with ERROR().
+static int dies(void (*f)(void *, void *), void *a, void *b) {
+    fflush(stdout);
+    pid_t pid = fork();
+    if (pid == 0) {
+        f(a, b);
+        _exit(0);
+    }
+    int status;
+    waitpid(pid, &status, 0);
+    return WIFEXITED(status) && WEXITSTATUS(status) == 1;
+}
+
+// Each element repeated 40 times, for deq_str/deq_fprint
+static Str wide(Data d) {
+    char *s = malloc(41);
+    for (int i = 0; i < 40; i++) s[i] = *(char *)d;
+    s[40] = 0;
+    return s;
+}
+
+// What deq_fprint writes, captured in a string
+static char *streamed(Deq q, DeqStrF f) {
+    static char *s = NULL;
+    size_t n;
+    free(s);
+    FILE *fp = open_memstream(&s, &n);
+    deq_fprint(q, fp, f);
+    fclose(fp);
+    return s;
+}
+
+static void rem(void *q, void *l) { ideq_rem(q, l); }
+static void del(void *q, void *unused) { (void)unused; deq_del(q, NULL); }
+static void cat(void *a, void *b) { deq_concat(a, b); }
 
 int main() {
     printf("Testing Deq with Buddy Allocator Wrapper...\n");
 
     Deq q = deq_new();
+    char *first = "First";
     
     // Add some data
-    deq_head_put(q, "First");
+    deq_head_put(q, first);
     deq_tail_put(q, "Last");
     deq_head_put(q, "NewHead");
 
@@ -20,7 +111,148 @@ int main() {
     printf("Head: %s\n", (char *)deq_head_get(q)); // Should be NewHead
     printf("Tail: %s\n", (char *)deq_tail_get(q)); // Should be Last
 
+    // Index and remove from both ends, across ring wrap-around and growth
+    char *v[20] = {"a","b","c","d","e","f","g","h","i","j",
+                   "k","l","m","n","o","p","q","r","s","t"};
+    for (int i = 9; i >= 0; i--) deq_head_put(q, v[i]);
+    for (int i = 10; i < 20; i++) deq_tail_put(q, v[i]);
+    assert(deq_len(q) == 21); // "First" is still in the middle
+    assert(deq_head_ith(q, 0) == v[0]);
+    assert(deq_tail_ith(q, 0) == v[19]);
+    assert(deq_head_ith(q, 11) == v[10]);
+    Data gone = deq_head_rem(q, first);
+    assert(gone == first);
+    gone = deq_tail_rem(q, v[3]);
+    assert(gone == v[3]);
+    gone = deq_tail_rem(q, v[3]); // Only one "d"
+    assert(gone == NULL);
+    assert(deq_head_ith(q, 3) == v[4]);
+    assert(deq_tail_ith(q, 18) == v[0]);
+
+    char *str = deq_str(q, NULL);
+    assert(strcmp(str, "a b c e f g h i j k l m n o p q r s t") == 0);
+    assert(strcmp(str, streamed(q, NULL)) == 0);
+    free(str);
+    str = deq_str(q, wide); // 19 x 41 bytes: regrows from 64 several times
+    assert(strlen(str) == 19 * 40 + 18);
+    assert(strncmp(str, "aaaa", 4) == 0 && str[40] == ' ' && str[41] == 'b');
+    assert(strcmp(str, streamed(q, wide)) == 0);
+    free(str);
+
+    // Empty elements are separated the same way by deq_str and deq_fprint
+    Deq e = deq_new();
+    deq_tail_put(e, "");
+    deq_tail_put(e, "x");
+    deq_tail_put(e, "y");
+    str = deq_str(e, NULL);
+    assert(strcmp(str, " x y") == 0);
+    assert(strcmp(str, streamed(e, NULL)) == 0);
+    free(str);
+    deq_del(e, NULL);
+
+    // Cursors from both ends
+    DeqIter cur = deq_tail_iter(q);
+    for (int i = 19; i >= 0; i--) {
+        if (i == 3) continue; // "d" was removed
+        Data d = deq_iter_next(&cur);
+        assert(d == v[i]);
+    }
+    assert(!deq_iter_more(&cur));
+    cur = deq_head_iter(q);
+    Data d0 = deq_iter_next(&cur);
+    Data d1 = deq_iter_next(&cur);
+    assert(d0 == v[0] && d1 == v[1]);
     deq_del(q, NULL);
+
+    // Bulk transfer, splice and split
+    Deq a = deq_new(), b = deq_new();
+    deq_tail_put_array(a, (Data *)v, 10);
+    deq_head_put_array(b, (Data *)v + 10, 10); // b is t s ... k
+    Data out[20];
+    int got3 = deq_tail_get_array(b, out, 3);
+    assert(got3 == 3 && out[0] == v[10] && out[2] == v[12]);
+    deq_concat(a, b);
+    assert(deq_len(a) == 17 && deq_len(b) == 0);
+    assert(deq_head_ith(a, 9) == v[9] && deq_head_ith(a, 10) == v[19]);
+    Deq c = deq_split_at(a, 12);
+    assert(deq_len(a) == 12 && deq_len(c) == 5);
+    assert(deq_tail_ith(a, 0) == v[18] && deq_head_ith(c, 0) == v[17]);
+    deq_concat(b, c);
+    int got5 = deq_head_get_array(b, out, 20); // Only 5 there
+    assert(got5 == 5 && out[4] == v[13]);
+    assert(deq_len(b) == 0);
+    deq_del(deq_split_at(a, 0), NULL);
+    assert(deq_len(a) == 0);
+    deq_del(a, NULL);
+    deq_del(b, NULL);
+    deq_del(c, NULL);
+
+    // Deque in a dedicated pool: deq_del hands the whole pool back
+    Balloc pool = bcreate(65536, 5, 12);
+    Deq pq = deq_new_in(pool);
+    for (int i = 0; i < 20; i++) deq_tail_put(pq, v[i]);
+    deq_head_put_array(pq, (Data *)v, 20);
+    assert(deq_len(pq) == 40 && deq_head_ith(pq, 0) == v[19]);
+    Deq ps = deq_split_at(pq, 30); // Shares the pool, deleted first
+    Data got = deq_head_get(ps);
+    assert(got == v[10]);
+    int early = dies(del, pq, NULL); // Owner before its sharer
+    assert(early);
+    Deq heap = deq_new();
+    int mixed = dies(cat, heap, ps); // Pools must match, in either backend
+    assert(mixed);
+    deq_del(heap, NULL);
+    deq_del(ps, NULL);
+    deq_del(pq, NULL);
+    for (int i = 0; i < 16; i++) {
+        void *page = balloc(pool, 4096);
+        assert(page != NULL);
+    }
+    bdelete(pool);
+
+    // Intrusive deque: caller-owned links, O(1) rem
+    IDeq iq;
+    struct item it[5];
+    ideq_init(&iq);
+    for (int i = 0; i < 5; i++) {
+        it[i].id = i;
+        ideq_tail_put(&iq, &it[i].link);
+    }
+    assert(ideq_len(&iq) == 5);
+    assert(IDEQ_ENTRY(ideq_head_ith(&iq, 1), struct item, link)->id == 1);
+    ideq_rem(&iq, &it[2].link);
+    ideq_rem(&iq, &it[4].link); // Tail end
+    int twice = dies(rem, &iq, &it[2].link); // Already removed
+    assert(twice);
+    assert(ideq_len(&iq) == 3);
+    assert(IDEQ_ENTRY(ideq_tail_ith(&iq, 0), struct item, link)->id == 3);
+    IDeqLink *l = ideq_tail_get(&iq);
+    assert(IDEQ_ENTRY(l, struct item, link)->id == 3);
+    l = ideq_head_get(&iq);
+    assert(IDEQ_ENTRY(l, struct item, link)->id == 0);
+    ideq_head_put(&iq, &it[4].link); // Links can be reused once removed
+    l = ideq_tail_get(&iq);
+    assert(IDEQ_ENTRY(l, struct item, link)->id == 1);
+    l = ideq_tail_get(&iq);
+    assert(IDEQ_ENTRY(l, struct item, link)->id == 4);
+    assert(ideq_len(&iq) == 0);
+
+    // Work-stealing deque, single-threaded: owner is LIFO, thief is FIFO
+    WSDeq w = wsdeq_new();
+    for (int i = 0; i < 100; i++) wsdeq_put(w, v[i % 20]); // Grows the ring
+    assert(wsdeq_len(w) == 100);
+    Data wd = wsdeq_get(w);
+    assert(wd == v[19]);
+    wd = wsdeq_steal(w);
+    assert(wd == v[0]);
+    wd = wsdeq_steal(w);
+    assert(wd == v[1]);
+    while (wsdeq_get(w)) ;
+    assert(wsdeq_len(w) == 0);
+    wd = wsdeq_steal(w);
+    assert(wd == NULL);
+    wsdeq_del(w);
+    wsdeq_race();
     
     printf("Deq test passed successfully using Buddy Allocator!\n");
     return 0;
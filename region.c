@@ -0,0 +1,91 @@
+// Purpose: Groups short-lived allocations so they can be dropped together, e.g. everything allocated while handling one request.
+//
+// Logic:
+// - Chunks: The region takes chunks of at least `chunk` bytes from its Balloc pool. Each chunk starts with a small header linking it to the previous chunk, forming a stack.
+// - ralloc: Bumps a pointer inside the top chunk. A request that does not fit pushes a new chunk (sized up for oversized requests). There is no per-object free.
+// - rmark: Returns the current bump pointer. It identifies both the chunk and the offset, so a mark needs no storage of its own.
+// - rrelease: Pops (bfree) every chunk pushed after the mark and rewinds the bump pointer. Cost is one bfree per chunk, independent of the number of objects. Releasing the zero mark empties the region.
+// - rdelete: Releases everything and returns the region descriptor, which itself lives in the pool.
+
+#include <limits.h>
+#include <stdlib.h>
+#include "region.h"
+
+static const size_t align=16;
+
+typedef struct chunk_s {
+    struct chunk_s *prev;
+    char *end;
+} *Chunk;
+
+typedef struct region_s {
+    Balloc pool;
+    unsigned int chunk;
+    Chunk top;
+    char *next;
+} *Rgn;
+
+static size_t alignup(size_t n) { return (n + align - 1) & ~(align - 1); }
+
+static char *first(Chunk c) { return (char *)c + alignup(sizeof(struct chunk_s)); }
+
+static int within(Chunk c, char *m) { return m >= first(c) && m <= c->end; }
+
+static int push(Rgn r, size_t size) {
+    size_t bytes = alignup(sizeof(struct chunk_s)) + size;
+    if (bytes < r->chunk) bytes = r->chunk;
+    if (bytes > UINT_MAX) return 0; // balloc() takes an unsigned int
+    Chunk c = balloc(r->pool, bytes);
+    if (!c) return 0;
+    c->prev = r->top;
+    c->end = (char *)c + bsize(r->pool, c);
+    r->top = c;
+    r->next = first(c);
+    return 1;
+}
+
+extern Region rcreate(Balloc pool, unsigned int chunk) {
+    if (!pool) return NULL;
+    Rgn r = balloc(pool, sizeof(struct region_s));
+    if (!r) return NULL;
+    r->pool = pool;
+    r->chunk = chunk;
+    r->top = NULL;
+    r->next = NULL;
+    return (Region)r;
+}
+
+extern void rdelete(Region region) {
+    Rgn r = (Rgn)region;
+    if (!r) return;
+    rrelease(r, NULL);
+    bfree(r->pool, r);
+}
+
+extern void *ralloc(Region region, unsigned int size) {
+    Rgn r = (Rgn)region;
+    if (!r) return NULL;
+    size_t bytes = alignup(size ? size : 1);
+    if (!r->top || (size_t)(r->top->end - r->next) < bytes)
+        if (!push(r, bytes) || (size_t)(r->top->end - r->next) < bytes)
+            return NULL;
+    void *mem = r->next;
+    r->next += bytes;
+    return mem;
+}
+
+extern RMark rmark(Region region) {
+    Rgn r = (Rgn)region;
+    return r ? (RMark)r->next : NULL;
+}
+
+extern void rrelease(Region region, RMark m) {
+    Rgn r = (Rgn)region;
+    if (!r) return;
+    while (r->top && !(m && within(r->top, m))) {
+        Chunk prev = r->top->prev;
+        bfree(r->pool, r->top);
+        r->top = prev;
+    }
+    r->next = r->top ? (char *)m : NULL;
+}
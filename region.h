@@ -0,0 +1,19 @@
+// A mark/release region (arena), layered on a Balloc pool.
+
+#ifndef REGION_H
+#define REGION_H
+
+#include "balloc.h"
+
+typedef void *Region;
+typedef void *RMark;
+
+extern Region rcreate(Balloc pool, unsigned int chunk);
+extern void   rdelete(Region r);
+
+extern void *ralloc(Region r, unsigned int size);
+
+extern RMark rmark(Region r);
+extern void  rrelease(Region r, RMark m);
+
+#endif
@@ -1,6 +1,8 @@
 #include <stdio.h>
 #include <assert.h>
+#include <limits.h>
 #include "balloc.h"
+#include "region.h"
 
 int main() {
     printf("Starting Buddy System Tests...\n");
@@ -26,6 +28,68 @@ int main() {
 
     bprint(pool);
     bdelete(pool);
+
+    // Test huge-page pool: base and order >= 21 blocks are 2 MB aligned
+    Balloc huge = bcreateopt(8 << 20, 4, 22, BHUGE); // 8MB, 16B min, 4MB max
+    assert(huge != NULL);
+    char *q1 = balloc(huge, 1 << 22); // The two 2^22 blocks cover the pool,
+    char *q2 = balloc(huge, 1 << 22); // so the lower one is the base
+    assert(q1 != NULL && q2 != NULL);
+    char *base = q1 < q2 ? q1 : q2;
+    assert(((unsigned long)base & ((1 << 21) - 1)) == 0);
+    bfree(huge, q1);
+    bfree(huge, q2);
+    void *h1 = balloc(huge, 100);
+    void *h2 = balloc(huge, 3 << 20); // Should get 2^22
+    void *h3 = balloc(huge, 1 << 21); // From the 2^22 block h1 split
+    assert(h2 != NULL && h3 != NULL);
+    assert(bsize(huge, h2) == 1 << 22);
+    assert(bsize(huge, h3) == 1 << 21);
+    assert(((unsigned long)h2 & ((1 << 21) - 1)) == 0);
+    assert(((unsigned long)h3 & ((1 << 21) - 1)) == 0);
+    bfree(huge, h1);
+    bfree(huge, h2);
+    bfree(huge, h3);
+    bdelete(huge);
+
+    // Test reset: everything comes back, same first block as a fresh pool
+    Balloc rp = bcreate(65536, 4, 12);
+    void *first = balloc(rp, 16);
+    for (int i = 0; i < 100; i++) balloc(rp, 100);
+    breset(rp);
+    void *again = balloc(rp, 16);
+    assert(again == first);
+    breset(rp);
+    for (int i = 0; i < 16; i++) {
+        void *page = balloc(rp, 4096);
+        assert(page != NULL);
+    }
+    void *none = balloc(rp, 16);
+    assert(none == NULL); // Pool exhausted
+    breset(rp);
+
+    // Test region mark/release
+    Region r = rcreate(rp, 1024);
+    assert(r != NULL);
+    char *a = ralloc(r, 10);
+    RMark m = rmark(r);
+    char *b = ralloc(r, 10);
+    assert(b == a + 16);
+    for (int i = 0; i < 50; i++) { // Spans chunks
+        void *o = ralloc(r, 100);
+        assert(o != NULL);
+    }
+    ralloc(r, 3000); // Oversized: own chunk
+    rrelease(r, m);
+    void *huge_obj = ralloc(r, UINT_MAX); // Too big for any chunk
+    assert(huge_obj == NULL);
+    char *c = ralloc(r, 10);
+    assert(c == b); // Rewound to the mark
+    rrelease(r, 0);
+    c = ralloc(r, 10);
+    assert(c != NULL);
+    rdelete(r);
+    bdelete(rp);
     
     printf("All tests passed!\n");
     return 0;
@@ -3,6 +3,8 @@
 // Memory Acquisition:
 // - mmalloc: The exclusive interface for requesting memory from the OS via mmap. It uses PROT_READ|PROT_WRITE and MAP_ANONYMOUS to provide a private, zero-initialized memory region.
 // - mmfree: Releases the mmap'd region back to the kernel.
+// - mmallocalign: Over-maps by one alignment unit and unmaps the slack on either side, so the returned region starts on an align boundary (e.g. 2 MB for huge pages). size should be a multiple of align.
+// - mmhuge: Asks the kernel to back a region with transparent huge pages (MADV_HUGEPAGE). Failure is harmless: the region simply stays on 4 KB pages.
 // Math Helpers:
 // - size2e: Converts a byte size into the smallest exponent e such that 2^e >= size.
 // - e2size: Computes 2^e using bit-shifting.
@@ -21,6 +23,23 @@ extern void mmfree(void *p, size_t size) {
     munmap(p, size);
 }
 
+extern void *mmallocalign(size_t size, size_t align) {
+    char *p = mmalloc(size + align);
+    if (p == (void *)-1) return p;
+    char *a = (char *)(((size_t)p + align - 1) & ~(align - 1));
+    if (a > p) munmap(p, a - p);
+    munmap(a + size, (p + align) - a);
+    return a;
+}
+
+extern int mmhuge(void *p, size_t size) {
+#ifdef MADV_HUGEPAGE
+    return madvise(p, size, MADV_HUGEPAGE);
+#else
+    return -1;
+#endif
+}
+
 extern size_t e2size(int e) {
     return (size_t)1 << e;
 }
@@ -4,9 +4,12 @@
 #include <stdio.h>
 
 static const int bitsperbyte=8;
+static const int hugepagee=21; // 2 MB transparent huge page
 
 extern void *mmalloc(size_t size);
 extern void mmfree(void *p, size_t size);
+extern void *mmallocalign(size_t size, size_t align);
+extern int mmhuge(void *p, size_t size);
 
 extern size_t divup(size_t n, size_t d);
 extern size_t bits2bytes(size_t bits);
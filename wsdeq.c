@@ -0,0 +1,154 @@
+#include <stdatomic.h>
+#include <stdlib.h>
+
+#include "wsdeq.h"
+#include "error.h"
+
+/**
+ * IMPLEMENTATION STRATEGY: Chase-Lev Circular Array
+ * * Following Chase & Lev (SPAA 2005), with the C11 memory orderings of
+ * Le, Pop, Cohen & Zappa Nardelli (PPoPP 2013).
+ * * - `top` and `bottom` are ever-increasing indices into a power-of-two
+ * ring; the elements are those in [top, bottom).
+ * - Only the owner moves `bottom` (put/get). Thieves and the owner race
+ * to advance `top` with a CAS, which is the only contended write.
+ * - When full, the owner copies into a ring twice the size. Thieves may
+ * still be reading the old ring, so it is kept on a retired list until
+ * wsdeq_del rather than freed.
+ */
+
+typedef struct Ring {
+  long cap; // power of two
+  struct Ring *retired; // older, smaller rings
+  _Atomic(Data) buf[];
+} *Ring;
+
+typedef struct {
+  atomic_long top;
+  atomic_long bottom;
+  _Atomic(Ring) ring;
+} *Rep;
+
+static const long mincap = 64;
+
+static Rep rep(WSDeq q) {
+  if (!q)
+    ERROR("zero pointer");
+  return (Rep)q;
+}
+
+static Ring ring_new(long cap) {
+  Ring a = (Ring)malloc(sizeof(*a) + cap * sizeof(a->buf[0]));
+  if (!a)
+    ERROR("malloc() failed");
+  a->cap = cap;
+  a->retired = 0;
+  return a;
+}
+
+static Data ring_get(Ring a, long i) {
+  return atomic_load_explicit(&a->buf[i & (a->cap - 1)], memory_order_relaxed);
+}
+
+static void ring_put(Ring a, long i, Data d) {
+  atomic_store_explicit(&a->buf[i & (a->cap - 1)], d, memory_order_relaxed);
+}
+
+/**
+ * grow: Owner only. Copy [t, b) into a ring of twice the size and publish it.
+ */
+static Ring grow(Rep r, Ring a, long t, long b) {
+  Ring n = ring_new(a->cap * 2);
+  for (long i = t; i < b; i++)
+    ring_put(n, i, ring_get(a, i));
+  n->retired = a;
+  atomic_store_explicit(&r->ring, n, memory_order_release);
+  return n;
+}
+
+extern WSDeq wsdeq_new() {
+  Rep r = (Rep)malloc(sizeof(*r));
+  if (!r)
+    ERROR("malloc() failed");
+  atomic_init(&r->top, 0);
+  atomic_init(&r->bottom, 0);
+  atomic_init(&r->ring, ring_new(mincap));
+  return r;
+}
+
+extern void wsdeq_del(WSDeq q) {
+  Ring a = atomic_load(&rep(q)->ring);
+  while (a) {
+    Ring next = a->retired;
+    free(a);
+    a = next;
+  }
+  free(q);
+}
+
+extern int wsdeq_len(WSDeq q) {
+  Rep r = rep(q);
+  long b = atomic_load_explicit(&r->bottom, memory_order_relaxed);
+  long t = atomic_load_explicit(&r->top, memory_order_relaxed);
+  return b > t ? (int)(b - t) : 0;
+}
+
+extern void wsdeq_put(WSDeq q, Data d) {
+  Rep r = rep(q);
+  long b = atomic_load_explicit(&r->bottom, memory_order_relaxed);
+  long t = atomic_load_explicit(&r->top, memory_order_acquire);
+  Ring a = atomic_load_explicit(&r->ring, memory_order_relaxed);
+  if (b - t > a->cap - 1)
+    a = grow(r, a, t, b);
+  ring_put(a, b, d);
+  atomic_thread_fence(memory_order_release);
+  atomic_store_explicit(&r->bottom, b + 1, memory_order_relaxed);
+}
+
+/**
+ * get: Take from the bottom.
+ * logic: Reserve slot b by decrementing `bottom` first. Only when it is
+ * the last element can a thief want it too; then both CAS `top`.
+ */
+extern Data wsdeq_get(WSDeq q) {
+  Rep r = rep(q);
+  long b = atomic_load_explicit(&r->bottom, memory_order_relaxed) - 1;
+  Ring a = atomic_load_explicit(&r->ring, memory_order_relaxed);
+  atomic_store_explicit(&r->bottom, b, memory_order_relaxed);
+  atomic_thread_fence(memory_order_seq_cst);
+  long t = atomic_load_explicit(&r->top, memory_order_relaxed);
+  if (t > b) { // empty
+    atomic_store_explicit(&r->bottom, b + 1, memory_order_relaxed);
+    return 0;
+  }
+  Data d = ring_get(a, b);
+  if (t == b) { // last one: race thieves for it
+    if (!atomic_compare_exchange_strong_explicit(&r->top, &t, t + 1,
+                                                 memory_order_seq_cst,
+                                                 memory_order_relaxed))
+      d = 0;
+    atomic_store_explicit(&r->bottom, b + 1, memory_order_relaxed);
+  }
+  return d;
+}
+
+/**
+ * steal: Take from the top.
+ * logic: Read the element, then claim it by advancing `top` with a CAS.
+ * Losing the CAS means another thief or the owner took it.
+ */
+extern Data wsdeq_steal(WSDeq q) {
+  Rep r = rep(q);
+  long t = atomic_load_explicit(&r->top, memory_order_acquire);
+  atomic_thread_fence(memory_order_seq_cst);
+  long b = atomic_load_explicit(&r->bottom, memory_order_acquire);
+  if (t >= b)
+    return 0;
+  Ring a = atomic_load_explicit(&r->ring, memory_order_acquire);
+  Data d = ring_get(a, t);
+  if (!atomic_compare_exchange_strong_explicit(&r->top, &t, t + 1,
+                                               memory_order_seq_cst,
+                                               memory_order_relaxed))
+    return 0;
+  return d;
+}
@@ -0,0 +1,25 @@
+#ifndef WSDEQ_H
+#define WSDEQ_H
+
+#include "deq.h"
+
+// A concurrent work-stealing deque (Chase-Lev), lock-free.
+//
+// put:   owner thread only, append at the bottom
+// get:   owner thread only, return from the bottom (LIFO)
+// steal: any thread, return from the top (FIFO)
+//
+// get and steal return 0 when there is nothing to take, and steal also
+// when it loses a race for the last element, so Data must be non-zero.
+
+typedef void *WSDeq;
+
+extern WSDeq wsdeq_new();
+extern void  wsdeq_del(WSDeq q); // no concurrent users
+extern int   wsdeq_len(WSDeq q); // a snapshot under concurrency
+
+extern void wsdeq_put(WSDeq q, Data d);
+extern Data wsdeq_get(WSDeq q);
+extern Data wsdeq_steal(WSDeq q);
+
+#endif